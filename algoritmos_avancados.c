@@ -6,14 +6,29 @@
 // ESTRUTURAS DE DADOS
 // ============================================================================
 
-// Estrutura para representar uma sala na árvore binária de navegação
+#define SEM_INDICE -1  // Ausência de sala, pista ou suspeito nas tabelas da mansão
+
+// Estrutura para representar uma sala na árvore binária de navegação.
+// Os filhos são índices na tabela de salas, e não ponteiros, para que a
+// mansão inteira possa ser uma tabela constante gerada em tempo de compilação.
 typedef struct Sala {
     char nome[50];
-    struct Sala* esquerda;
-    struct Sala* direita;
-    char pista[100];  // Pista encontrada nesta sala (usado nos níveis Aventureiro e Mestre)
+    int esquerda;     // Índice da sala à esquerda (ou SEM_INDICE)
+    int direita;      // Índice da sala à direita (ou SEM_INDICE)
+    int pista;        // Índice da pista desta sala (usado nos níveis Aventureiro e Mestre)
 } Sala;
 
+// Estrutura para representar uma pista da mansão e o suspeito ligado a ela
+typedef struct PistaMansao {
+    char texto[100];
+    int suspeito;     // Índice do suspeito associado (ou SEM_INDICE)
+} PistaMansao;
+
+// Estrutura para representar um suspeito da mansão
+typedef struct SuspeitoMansao {
+    char nome[50];
+} SuspeitoMansao;
+
 // Estrutura para representar uma pista na árvore de busca (BST)
 typedef struct PistaBST {
     char texto[100];
@@ -35,66 +50,92 @@ typedef struct Suspeito {
     struct Suspeito* proximo;  // Para tratamento de colisões
 } Suspeito;
 
+// Tabelas da mansão (salasMansao, pistasMansao, suspeitosMansao), geradas
+// por gerar_mansao a partir de mansao.txt ("make mansao"). São "static const",
+// então ficam em memória somente leitura e não precisam ser montadas.
+#include "mansao_gerada.h"
+
+#define SALA_RAIZ 0  // A primeira sala da descrição é a entrada da mansão
+
 // ============================================================================
-// NÍVEL NOVATO: ÁRVORE BINÁRIA DE NAVEGAÇÃO
+// DIÁRIO DE INVESTIGAÇÃO: GRAVAÇÃO
 // ============================================================================
 
-// Função para criar uma nova sala
-Sala* criarSala(const char* nome, const char* pista) {
-    Sala* novaSala = (Sala*)malloc(sizeof(Sala));
-    if (novaSala == NULL) {
-        printf("Erro ao alocar memória!\n");
-        exit(1);
+// O diário é um arquivo binário, somente de anexação, com os eventos da
+// investigação em andamento. Se o processo morrer no meio de uma partida,
+// a próxima partida do mesmo nível reproduz o diário e continua dali.
+//
+// Formato: assinatura "DQD3" + 1 byte com o nível + 4 bytes (little-endian)
+// com IMPRESSAO_MANSAO, seguidos dos eventos. Cada evento tem 2 bytes: o tipo
+// e um índice nas tabelas da mansão. A impressão digital garante que os
+// índices se referem às mesmas tabelas na hora de reproduzir o diário.
+#define ARQUIVO_DIARIO "detective_quest.diario"
+#define ARQUIVO_DIARIO_TEMPORARIO "detective_quest.diario.tmp"
+#define ASSINATURA_DIARIO "DQD3"
+#define TAMANHO_ASSINATURA 4
+#define TAMANHO_CABECALHO_DIARIO (TAMANHO_ASSINATURA + 1 + 4)
+#define TAMANHO_EVENTO_DIARIO 2
+#define TAMANHO_BUFFER_DIARIO 4096
+
+// Os índices são gravados em um único byte
+#if TOTAL_SALAS > 256 || TOTAL_PISTAS > 256
+#error "A mansão tem salas ou pistas demais para o diário de investigação"
+#endif
+
+// Tipos de evento gravados no diário. No nível Mestre, o suspeito de cada
+// pista vem de pistasMansao, então não precisa de um evento próprio.
+#define EVENTO_MOVIMENTO 'M'  // Índice da sala para onde o jogador foi
+#define EVENTO_PISTA 'P'      // Índice da pista coletada na sala atual
+
+// Estado do diário da partida atual
+FILE* arquivoDiario = NULL;
+unsigned char bufferDiario[TAMANHO_BUFFER_DIARIO];
+size_t usadoBufferDiario = 0;
+
+// Função para gravar em disco, com uma única escrita, todos os eventos
+// acumulados no buffer (commit em grupo)
+void confirmarDiario() {
+    if (arquivoDiario == NULL || usadoBufferDiario == 0) {
+        return;
+    }
+    if (fwrite(bufferDiario, 1, usadoBufferDiario, arquivoDiario) != usadoBufferDiario ||
+        fflush(arquivoDiario) != 0) {
+        printf("Aviso: falha ao gravar o diário de investigação.\n");
     }
-    strcpy(novaSala->nome, nome);
-    strcpy(novaSala->pista, pista);
-    novaSala->esquerda = NULL;
-    novaSala->direita = NULL;
-    return novaSala;
+    usadoBufferDiario = 0;
 }
 
-// Função para construir a árvore da mansão
-Sala* construirMansao() {
-    // Criar todas as salas
-    Sala* hall = criarSala("Hall de Entrada", "");
-    Sala* biblioteca = criarSala("Biblioteca", "Livro com páginas arrancadas");
-    Sala* cozinha = criarSala("Cozinha", "Faca desaparecida");
-    Sala* sala = criarSala("Sala de Estar", "Copo quebrado");
-    Sala* quarto = criarSala("Quarto Principal", "Carta rasgada");
-    Sala* banheiro = criarSala("Banheiro", "Espelho quebrado");
-    Sala* sotao = criarSala("Sótão", "Baú trancado");
-    Sala* porao = criarSala("Porão", "Corda manchada");
-
-    // Conectar as salas formando a árvore binária
-    // Estrutura hierárquica: Hall -> Biblioteca/Cozinha/Sótão e Sala/Quarto/Banheiro/Porão
-
-    hall->esquerda = biblioteca;
-    hall->direita = sala;
-
-    biblioteca->esquerda = cozinha;
-    biblioteca->direita = sotao;
-
-    sala->esquerda = quarto;
-    sala->direita = banheiro;
-
-    banheiro->esquerda = porao;
-    banheiro->direita = NULL;
-
-    return hall;
+// Função para registrar um evento no diário. O evento fica no buffer e só
+// vai para o disco em confirmarDiario() (ou quando o buffer enche).
+void registrarEvento(char tipo, int indice) {
+    if (arquivoDiario == NULL) {
+        return;
+    }
+    if (usadoBufferDiario + TAMANHO_EVENTO_DIARIO > TAMANHO_BUFFER_DIARIO) {
+        confirmarDiario();
+    }
+    bufferDiario[usadoBufferDiario++] = (unsigned char)tipo;
+    bufferDiario[usadoBufferDiario++] = (unsigned char)indice;
 }
 
+// ============================================================================
+// NÍVEL NOVATO: ÁRVORE BINÁRIA DE NAVEGAÇÃO
+// ============================================================================
+
 // Função para explorar as salas (Nível Novato)
-void explorarSalas(Sala* salaAtual) {
-    if (salaAtual == NULL) {
+void explorarSalas(int indiceSala) {
+    if (indiceSala == SEM_INDICE) {
         printf("Você chegou ao fim do caminho!\n");
         return;
     }
 
+    const Sala* salaAtual = &salasMansao[indiceSala];
+
     printf("\n=== Você está em: %s ===\n", salaAtual->nome);
 
     // Verificar se há caminhos disponíveis
-    int temEsquerda = (salaAtual->esquerda != NULL);
-    int temDireita = (salaAtual->direita != NULL);
+    int temEsquerda = (salaAtual->esquerda != SEM_INDICE);
+    int temDireita = (salaAtual->direita != SEM_INDICE);
 
     if (!temEsquerda && !temDireita) {
         printf("Este é um cômodo sem saída. Você chegou ao fim do caminho!\n");
@@ -103,14 +144,17 @@ void explorarSalas(Sala* salaAtual) {
 
     printf("Para onde deseja ir?\n");
     if (temEsquerda) {
-        printf("  [e] Esquerda -> %s\n", salaAtual->esquerda->nome);
+        printf("  [e] Esquerda -> %s\n", salasMansao[salaAtual->esquerda].nome);
     }
     if (temDireita) {
-        printf("  [d] Direita -> %s\n", salaAtual->direita->nome);
+        printf("  [d] Direita -> %s\n", salasMansao[salaAtual->direita].nome);
     }
     printf("  [s] Sair da exploração\n");
     printf("Escolha: ");
 
+    // Confirmar no diário os eventos desta jogada antes de esperar o jogador
+    confirmarDiario();
+
     char escolha;
     scanf(" %c", &escolha);
 
@@ -118,19 +162,21 @@ void explorarSalas(Sala* salaAtual) {
         case 'e':
         case 'E':
             if (temEsquerda) {
+                registrarEvento(EVENTO_MOVIMENTO, salaAtual->esquerda);
                 explorarSalas(salaAtual->esquerda);
             } else {
                 printf("Não há caminho à esquerda!\n");
-                explorarSalas(salaAtual);
+                explorarSalas(indiceSala);
             }
             break;
         case 'd':
         case 'D':
             if (temDireita) {
+                registrarEvento(EVENTO_MOVIMENTO, salaAtual->direita);
                 explorarSalas(salaAtual->direita);
             } else {
                 printf("Não há caminho à direita!\n");
-                explorarSalas(salaAtual);
+                explorarSalas(indiceSala);
             }
             break;
         case 's':
@@ -139,20 +185,11 @@ void explorarSalas(Sala* salaAtual) {
             return;
         default:
             printf("Opção inválida! Tente novamente.\n");
-            explorarSalas(salaAtual);
+            explorarSalas(indiceSala);
             break;
     }
 }
 
-// Função para liberar memória da árvore de salas
-void liberarSalas(Sala* sala) {
-    if (sala != NULL) {
-        liberarSalas(sala->esquerda);
-        liberarSalas(sala->direita);
-        free(sala);
-    }
-}
-
 // ============================================================================
 // NÍVEL AVENTUREIRO: ÁRVORE DE BUSCA (BST) PARA PISTAS
 // ============================================================================
@@ -222,25 +259,29 @@ void liberarBST(PistaBST* raiz) {
 }
 
 // Função para explorar salas e coletar pistas (Nível Aventureiro)
-void explorarSalasComPistas(Sala* salaAtual, PistaBST** raizPistas) {
-    if (salaAtual == NULL) {
+void explorarSalasComPistas(int indiceSala, PistaBST** raizPistas) {
+    if (indiceSala == SEM_INDICE) {
         printf("Você chegou ao fim do caminho!\n");
         return;
     }
 
+    const Sala* salaAtual = &salasMansao[indiceSala];
+
     printf("\n=== Você está em: %s ===\n", salaAtual->nome);
 
     // Se a sala tem uma pista e ela ainda não foi coletada, adicionar à BST
-    if (strlen(salaAtual->pista) > 0) {
-        if (!buscarPistaBST(*raizPistas, salaAtual->pista)) {
-            *raizPistas = inserirPistaBST(*raizPistas, salaAtual->pista);
-            printf("🔍 PISTA ENCONTRADA: %s\n", salaAtual->pista);
+    if (salaAtual->pista != SEM_INDICE) {
+        const char* pista = pistasMansao[salaAtual->pista].texto;
+        if (!buscarPistaBST(*raizPistas, pista)) {
+            *raizPistas = inserirPistaBST(*raizPistas, pista);
+            registrarEvento(EVENTO_PISTA, salaAtual->pista);
+            printf("🔍 PISTA ENCONTRADA: %s\n", pista);
         }
     }
 
     // Verificar se há caminhos disponíveis
-    int temEsquerda = (salaAtual->esquerda != NULL);
-    int temDireita = (salaAtual->direita != NULL);
+    int temEsquerda = (salaAtual->esquerda != SEM_INDICE);
+    int temDireita = (salaAtual->direita != SEM_INDICE);
 
     if (!temEsquerda && !temDireita) {
         printf("Este é um cômodo sem saída. Você chegou ao fim do caminho!\n");
@@ -249,15 +290,18 @@ void explorarSalasComPistas(Sala* salaAtual, PistaBST** raizPistas) {
 
     printf("Para onde deseja ir?\n");
     if (temEsquerda) {
-        printf("  [e] Esquerda -> %s\n", salaAtual->esquerda->nome);
+        printf("  [e] Esquerda -> %s\n", salasMansao[salaAtual->esquerda].nome);
     }
     if (temDireita) {
-        printf("  [d] Direita -> %s\n", salaAtual->direita->nome);
+        printf("  [d] Direita -> %s\n", salasMansao[salaAtual->direita].nome);
     }
     printf("  [s] Sair da exploração\n");
     printf("  [p] Ver pistas coletadas\n");
     printf("Escolha: ");
 
+    // Confirmar no diário os eventos desta jogada antes de esperar o jogador
+    confirmarDiario();
+
     char escolha;
     scanf(" %c", &escolha);
 
@@ -265,19 +309,21 @@ void explorarSalasComPistas(Sala* salaAtual, PistaBST** raizPistas) {
         case 'e':
         case 'E':
             if (temEsquerda) {
+                registrarEvento(EVENTO_MOVIMENTO, salaAtual->esquerda);
                 explorarSalasComPistas(salaAtual->esquerda, raizPistas);
             } else {
                 printf("Não há caminho à esquerda!\n");
-                explorarSalasComPistas(salaAtual, raizPistas);
+                explorarSalasComPistas(indiceSala, raizPistas);
             }
             break;
         case 'd':
         case 'D':
             if (temDireita) {
+                registrarEvento(EVENTO_MOVIMENTO, salaAtual->direita);
                 explorarSalasComPistas(salaAtual->direita, raizPistas);
             } else {
                 printf("Não há caminho à direita!\n");
-                explorarSalasComPistas(salaAtual, raizPistas);
+                explorarSalasComPistas(indiceSala, raizPistas);
             }
             break;
         case 'p':
@@ -288,7 +334,7 @@ void explorarSalasComPistas(Sala* salaAtual, PistaBST** raizPistas) {
             } else {
                 listarPistasEmOrdem(*raizPistas);
             }
-            explorarSalasComPistas(salaAtual, raizPistas);
+            explorarSalasComPistas(indiceSala, raizPistas);
             break;
         case 's':
         case 'S':
@@ -296,7 +342,7 @@ void explorarSalasComPistas(Sala* salaAtual, PistaBST** raizPistas) {
             return;
         default:
             printf("Opção inválida! Tente novamente.\n");
-            explorarSalasComPistas(salaAtual, raizPistas);
+            explorarSalasComPistas(indiceSala, raizPistas);
             break;
     }
 }
@@ -310,12 +356,16 @@ void explorarSalasComPistas(Sala* salaAtual, PistaBST** raizPistas) {
 // Tabela hash global
 Suspeito* tabelaHash[TAMANHO_HASH];
 
-// Função de hash simples baseada na primeira letra do nome
+// Função de hash simples baseada na primeira letra do nome. Nomes que
+// começam antes de 'A' (dígitos, pontuação) dariam resto negativo, então o
+// índice é trazido de volta para 0..TAMANHO_HASH-1 sem mudar o balde dos
+// nomes que começam com letra.
 int funcaoHash(const char* nome) {
     if (nome == NULL || strlen(nome) == 0) {
         return 0;
     }
-    return (nome[0] - 'A') % TAMANHO_HASH;
+    int indice = ((unsigned char)nome[0] - 'A') % TAMANHO_HASH;
+    return indice < 0 ? indice + TAMANHO_HASH : indice;
 }
 
 // Função para inicializar a tabela hash
@@ -468,47 +518,40 @@ void liberarHash() {
             free(atual);
             atual = proximo;
         }
+        tabelaHash[i] = NULL;
     }
 }
 
 // Função para explorar salas e relacionar pistas a suspeitos (Nível Mestre)
-void explorarSalasComSuspeitos(Sala* salaAtual, PistaBST** raizPistas) {
-    if (salaAtual == NULL) {
+void explorarSalasComSuspeitos(int indiceSala, PistaBST** raizPistas) {
+    if (indiceSala == SEM_INDICE) {
         printf("Você chegou ao fim do caminho!\n");
         return;
     }
 
+    const Sala* salaAtual = &salasMansao[indiceSala];
+
     printf("\n=== Você está em: %s ===\n", salaAtual->nome);
 
     // Se a sala tem uma pista e ela ainda não foi coletada
-    if (strlen(salaAtual->pista) > 0) {
-        if (!buscarPistaBST(*raizPistas, salaAtual->pista)) {
-            *raizPistas = inserirPistaBST(*raizPistas, salaAtual->pista);
-            printf("🔍 PISTA ENCONTRADA: %s\n", salaAtual->pista);
-
-            // Relacionar pista a suspeitos (lógica do jogo)
-            // Cada pista está associada a um suspeito específico
-            if (strcmp(salaAtual->pista, "Livro com páginas arrancadas") == 0) {
-                inserirNaHash(salaAtual->pista, "Professor");
-            } else if (strcmp(salaAtual->pista, "Faca desaparecida") == 0) {
-                inserirNaHash(salaAtual->pista, "Chef");
-            } else if (strcmp(salaAtual->pista, "Copo quebrado") == 0) {
-                inserirNaHash(salaAtual->pista, "Mordomo");
-            } else if (strcmp(salaAtual->pista, "Carta rasgada") == 0) {
-                inserirNaHash(salaAtual->pista, "Herdeiro");
-            } else if (strcmp(salaAtual->pista, "Espelho quebrado") == 0) {
-                inserirNaHash(salaAtual->pista, "Herdeiro");
-            } else if (strcmp(salaAtual->pista, "Baú trancado") == 0) {
-                inserirNaHash(salaAtual->pista, "Herdeiro");
-            } else if (strcmp(salaAtual->pista, "Corda manchada") == 0) {
-                inserirNaHash(salaAtual->pista, "Mordomo");
+    if (salaAtual->pista != SEM_INDICE) {
+        const PistaMansao* pista = &pistasMansao[salaAtual->pista];
+        if (!buscarPistaBST(*raizPistas, pista->texto)) {
+            *raizPistas = inserirPistaBST(*raizPistas, pista->texto);
+            registrarEvento(EVENTO_PISTA, salaAtual->pista);
+            printf("🔍 PISTA ENCONTRADA: %s\n", pista->texto);
+
+            // Relacionar a pista ao suspeito definido no mapa da mansão
+            if (pista->suspeito != SEM_INDICE) {
+                const char* suspeito = suspeitosMansao[pista->suspeito].nome;
+                inserirNaHash(pista->texto, suspeito);
             }
         }
     }
 
     // Verificar se há caminhos disponíveis
-    int temEsquerda = (salaAtual->esquerda != NULL);
-    int temDireita = (salaAtual->direita != NULL);
+    int temEsquerda = (salaAtual->esquerda != SEM_INDICE);
+    int temDireita = (salaAtual->direita != SEM_INDICE);
 
     if (!temEsquerda && !temDireita) {
         printf("Este é um cômodo sem saída. Você chegou ao fim do caminho!\n");
@@ -517,10 +560,10 @@ void explorarSalasComSuspeitos(Sala* salaAtual, PistaBST** raizPistas) {
 
     printf("Para onde deseja ir?\n");
     if (temEsquerda) {
-        printf("  [e] Esquerda -> %s\n", salaAtual->esquerda->nome);
+        printf("  [e] Esquerda -> %s\n", salasMansao[salaAtual->esquerda].nome);
     }
     if (temDireita) {
-        printf("  [d] Direita -> %s\n", salaAtual->direita->nome);
+        printf("  [d] Direita -> %s\n", salasMansao[salaAtual->direita].nome);
     }
     printf("  [s] Sair da exploração\n");
     printf("  [p] Ver pistas coletadas\n");
@@ -528,6 +571,9 @@ void explorarSalasComSuspeitos(Sala* salaAtual, PistaBST** raizPistas) {
     printf("  [c] Ver suspeito mais provável\n");
     printf("Escolha: ");
 
+    // Confirmar no diário os eventos desta jogada antes de esperar o jogador
+    confirmarDiario();
+
     char escolha;
     scanf(" %c", &escolha);
 
@@ -535,19 +581,21 @@ void explorarSalasComSuspeitos(Sala* salaAtual, PistaBST** raizPistas) {
         case 'e':
         case 'E':
             if (temEsquerda) {
+                registrarEvento(EVENTO_MOVIMENTO, salaAtual->esquerda);
                 explorarSalasComSuspeitos(salaAtual->esquerda, raizPistas);
             } else {
                 printf("Não há caminho à esquerda!\n");
-                explorarSalasComSuspeitos(salaAtual, raizPistas);
+                explorarSalasComSuspeitos(indiceSala, raizPistas);
             }
             break;
         case 'd':
         case 'D':
             if (temDireita) {
+                registrarEvento(EVENTO_MOVIMENTO, salaAtual->direita);
                 explorarSalasComSuspeitos(salaAtual->direita, raizPistas);
             } else {
                 printf("Não há caminho à direita!\n");
-                explorarSalasComSuspeitos(salaAtual, raizPistas);
+                explorarSalasComSuspeitos(indiceSala, raizPistas);
             }
             break;
         case 'p':
@@ -558,17 +606,17 @@ void explorarSalasComSuspeitos(Sala* salaAtual, PistaBST** raizPistas) {
             } else {
                 listarPistasEmOrdem(*raizPistas);
             }
-            explorarSalasComSuspeitos(salaAtual, raizPistas);
+            explorarSalasComSuspeitos(indiceSala, raizPistas);
             break;
         case 'a':
         case 'A':
             listarAssociacoes();
-            explorarSalasComSuspeitos(salaAtual, raizPistas);
+            explorarSalasComSuspeitos(indiceSala, raizPistas);
             break;
         case 'c':
         case 'C':
             encontrarSuspeitoMaisProvavel();
-            explorarSalasComSuspeitos(salaAtual, raizPistas);
+            explorarSalasComSuspeitos(indiceSala, raizPistas);
             break;
         case 's':
         case 'S':
@@ -576,9 +624,198 @@ void explorarSalasComSuspeitos(Sala* salaAtual, PistaBST** raizPistas) {
             return;
         default:
             printf("Opção inválida! Tente novamente.\n");
-            explorarSalasComSuspeitos(salaAtual, raizPistas);
+            explorarSalasComSuspeitos(indiceSala, raizPistas);
+            break;
+    }
+}
+
+// ============================================================================
+// DIÁRIO DE INVESTIGAÇÃO: RECUPERAÇÃO
+// ============================================================================
+
+// Função para ler o diário inteiro para a memória (NULL se não existir)
+unsigned char* lerArquivoDiario(size_t* tamanho) {
+    *tamanho = 0;
+    FILE* arquivo = fopen(ARQUIVO_DIARIO, "rb");
+    if (arquivo == NULL) {
+        return NULL;
+    }
+
+    fseek(arquivo, 0, SEEK_END);
+    long fim = ftell(arquivo);
+    fseek(arquivo, 0, SEEK_SET);
+    if (fim <= 0) {
+        fclose(arquivo);
+        return NULL;
+    }
+
+    unsigned char* dados = (unsigned char*)malloc((size_t)fim);
+    if (dados == NULL) {
+        printf("Erro ao alocar memória!\n");
+        exit(1);
+    }
+    *tamanho = fread(dados, 1, (size_t)fim, arquivo);
+    fclose(arquivo);
+    return dados;
+}
+
+// Função para reproduzir os eventos do diário, reconstruindo a sala atual,
+// a BST de pistas e a tabela hash de suspeitos. Um movimento só é aceito se
+// levar a um filho da sala atual, e uma pista só se for a da sala atual e o
+// nível coletar pistas. Para no primeiro evento incompleto ou inválido (por
+// exemplo, uma escrita interrompida pela queda do processo) e retorna quantos
+// bytes do diário são válidos.
+size_t reproduzirDiario(const unsigned char* dados, size_t tamanho, int nivel, int* indiceSala,
+                        PistaBST** raizPistas, int* eventos) {
+    size_t pos = TAMANHO_CABECALHO_DIARIO;
+
+    while (pos + TAMANHO_EVENTO_DIARIO <= tamanho) {
+        char tipo = (char)dados[pos];
+        int indice = dados[pos + 1];
+        const Sala* salaAtual = &salasMansao[*indiceSala];
+
+        if (tipo == EVENTO_MOVIMENTO) {
+            if (indice != salaAtual->esquerda && indice != salaAtual->direita) {
+                break;
+            }
+            *indiceSala = indice;
+        } else if (tipo == EVENTO_PISTA && nivel >= 2) {
+            if (indice != salaAtual->pista) {
+                break;
+            }
+            const PistaMansao* pista = &pistasMansao[indice];
+            *raizPistas = inserirPistaBST(*raizPistas, pista->texto);
+            if (nivel == 3 && pista->suspeito != SEM_INDICE) {
+                inserirNaHash(pista->texto, suspeitosMansao[pista->suspeito].nome);
+            }
+        } else {
             break;
+        }
+
+        pos += TAMANHO_EVENTO_DIARIO;
+        (*eventos)++;
+    }
+
+    return pos;
+}
+
+// Função para ler a impressão digital do mapa gravada no cabeçalho do diário
+unsigned long lerImpressaoDiario(const unsigned char* dados) {
+    unsigned long impressao = 0;
+    for (int i = 0; i < 4; i++) {
+        impressao |= (unsigned long)dados[TAMANHO_ASSINATURA + 1 + i] << (8 * i);
+    }
+    return impressao;
+}
+
+// Função para gravar o cabeçalho de um diário novo
+void escreverCabecalhoDiario(FILE* arquivo, int nivel) {
+    unsigned char cabecalho[TAMANHO_CABECALHO_DIARIO];
+    memcpy(cabecalho, ASSINATURA_DIARIO, TAMANHO_ASSINATURA);
+    cabecalho[TAMANHO_ASSINATURA] = (unsigned char)nivel;
+    for (int i = 0; i < 4; i++) {
+        cabecalho[TAMANHO_ASSINATURA + 1 + i] = (unsigned char)(IMPRESSAO_MANSAO >> (8 * i));
     }
+    fwrite(cabecalho, 1, TAMANHO_CABECALHO_DIARIO, arquivo);
+}
+
+// Função para substituir o diário por um novo conteúdo (a parte válida do
+// diário antigo ou só o cabeçalho). O conteúdo é gravado primeiro em um
+// arquivo temporário, que então toma o lugar do diário com rename(): se o
+// processo morrer no meio, o diário antigo continua intacto.
+int regravarDiario(const unsigned char* dados, size_t validos, int nivel) {
+    FILE* temporario = fopen(ARQUIVO_DIARIO_TEMPORARIO, "wb");
+    if (temporario == NULL) {
+        return 0;
+    }
+    if (validos > 0) {
+        fwrite(dados, 1, validos, temporario);
+    } else {
+        escreverCabecalhoDiario(temporario, nivel);
+    }
+    if (fflush(temporario) != 0 || ferror(temporario)) {
+        fclose(temporario);
+        remove(ARQUIVO_DIARIO_TEMPORARIO);
+        return 0;
+    }
+    fclose(temporario);
+
+    if (rename(ARQUIVO_DIARIO_TEMPORARIO, ARQUIVO_DIARIO) != 0) {
+        // Em alguns sistemas rename() não substitui um arquivo existente
+        remove(ARQUIVO_DIARIO);
+        if (rename(ARQUIVO_DIARIO_TEMPORARIO, ARQUIVO_DIARIO) != 0) {
+            remove(ARQUIVO_DIARIO_TEMPORARIO);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+// Função para abrir o diário de uma nova partida. Se existir um diário do
+// mesmo nível deixado por uma partida interrompida, ele é reproduzido e a
+// sala onde o jogador estava é retornada; caso contrário, retorna a raiz.
+// Se o diário for de outro nível, o jogador decide se quer descartá-lo;
+// se não quiser, retorna SEM_INDICE e a partida não começa.
+int iniciarDiario(int nivel, PistaBST** raizPistas) {
+    int indiceSala = SALA_RAIZ;
+    size_t tamanho = 0;
+    size_t validos = 0;
+    unsigned char* dados = lerArquivoDiario(&tamanho);
+
+    if (dados != NULL && tamanho >= TAMANHO_CABECALHO_DIARIO &&
+        memcmp(dados, ASSINATURA_DIARIO, TAMANHO_ASSINATURA) == 0) {
+        int nivelDiario = dados[TAMANHO_ASSINATURA];
+        if (lerImpressaoDiario(dados) != IMPRESSAO_MANSAO) {
+            // Os movimentos e pistas do diário se referem a outro mapa
+            printf("⚠️  O mapa da mansão mudou desde a investigação interrompida do nível %d.\n",
+                   nivelDiario);
+            printf("Essa investigação não pode ser retomada e foi descartada.\n");
+        } else if (nivelDiario == nivel) {
+            int eventos = 0;
+            validos = reproduzirDiario(dados, tamanho, nivel, &indiceSala, raizPistas, &eventos);
+            if (eventos > 0) {
+                printf("📖 Investigação anterior recuperada do diário (%d evento(s)).\n", eventos);
+            }
+        } else {
+            printf("⚠️  Existe uma investigação interrompida no nível %d.\n", nivelDiario);
+            printf("Começar o nível %d vai descartá-la. Deseja continuar? [s/n]: ", nivel);
+            char resposta;
+            scanf(" %c", &resposta);
+            if (resposta != 's' && resposta != 'S') {
+                printf("Escolha o nível %d no menu para retomar a investigação.\n", nivelDiario);
+                free(dados);
+                return SEM_INDICE;
+            }
+            printf("Investigação do nível %d descartada.\n", nivelDiario);
+        }
+    }
+
+    usadoBufferDiario = 0;
+    // Diário íntegro: continuar anexando ao final. Sem diário, diário de
+    // outro nível ou mapa, ou com final incompleto: regravar apenas a parte
+    // válida antes de anexar.
+    if ((validos > 0 && validos == tamanho) || regravarDiario(dados, validos, nivel)) {
+        arquivoDiario = fopen(ARQUIVO_DIARIO, "ab");
+    }
+
+    if (arquivoDiario == NULL) {
+        printf("Aviso: não foi possível abrir o diário; a partida não será recuperável.\n");
+    }
+
+    free(dados);
+    return indiceSala;
+}
+
+// Função para encerrar o diário ao fim normal de uma partida. A investigação
+// terminou, então não há nada a recuperar e o arquivo é removido.
+void encerrarDiario() {
+    if (arquivoDiario == NULL) {
+        return;
+    }
+    fclose(arquivoDiario);
+    arquivoDiario = NULL;
+    usadoBufferDiario = 0;
+    remove(ARQUIVO_DIARIO);
 }
 
 // ============================================================================
@@ -611,9 +848,12 @@ int main() {
                 // Nível Novato: Apenas navegação
                 printf("\n=== 🌱 NÍVEL NOVATO: MAPA DA MANSÃO ===\n");
                 printf("Explore a mansão usando 'e' (esquerda), 'd' (direita) ou 's' (sair)\n\n");
-                Sala* raizMansao = construirMansao();
-                explorarSalas(raizMansao);
-                liberarSalas(raizMansao);
+                int salaInicial = iniciarDiario(1, NULL);
+                if (salaInicial == SEM_INDICE) {
+                    break;
+                }
+                explorarSalas(salaInicial);
+                encerrarDiario();
                 break;
             }
 
@@ -622,9 +862,13 @@ int main() {
                 printf("\n=== 🔍 NÍVEL AVENTUREIRO: COLETA DE PISTAS ===\n");
                 printf("Explore a mansão e colete pistas!\n");
                 printf("Use 'p' para ver suas pistas coletadas.\n\n");
-                Sala* raizMansao = construirMansao();
                 PistaBST* raizPistas = NULL;
-                explorarSalasComPistas(raizMansao, &raizPistas);
+                int salaInicial = iniciarDiario(2, &raizPistas);
+                if (salaInicial == SEM_INDICE) {
+                    break;
+                }
+                explorarSalasComPistas(salaInicial, &raizPistas);
+                encerrarDiario();
                 
                 printf("\n=== RESUMO FINAL ===\n");
                 printf("Pistas coletadas:\n");
@@ -634,7 +878,6 @@ int main() {
                     listarPistasEmOrdem(raizPistas);
                 }
                 
-                liberarSalas(raizMansao);
                 liberarBST(raizPistas);
                 break;
             }
@@ -646,9 +889,13 @@ int main() {
                 printf("Use 'p' para ver pistas, 'a' para associações e 'c' para o suspeito mais provável.\n\n");
                 
                 inicializarHash();
-                Sala* raizMansao = construirMansao();
                 PistaBST* raizPistas = NULL;
-                explorarSalasComSuspeitos(raizMansao, &raizPistas);
+                int salaInicial = iniciarDiario(3, &raizPistas);
+                if (salaInicial == SEM_INDICE) {
+                    break;
+                }
+                explorarSalasComSuspeitos(salaInicial, &raizPistas);
+                encerrarDiario();
                 
                 printf("\n=== ANÁLISE FINAL ===\n");
                 printf("\nPistas coletadas:\n");
@@ -661,7 +908,6 @@ int main() {
                 listarAssociacoes();
                 encontrarSuspeitoMaisProvavel();
                 
-                liberarSalas(raizMansao);
                 liberarBST(raizPistas);
                 liberarHash();
                 break;
@@ -0,0 +1,429 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Gerador da mansão: compila a descrição textual da mansão (mansao.txt) em
+// um cabeçalho C com tabelas "static const" de salas, pistas e suspeitos.
+// Uso: ./gerar_mansao mansao.txt mansao_gerada.h
+
+// ============================================================================
+// ESTRUTURAS DE DADOS
+// ============================================================================
+
+#define MAXIMO_SALAS 256  // O diário do jogo grava índices de salas e pistas em 1 byte
+#define TAMANHO_LINHA 512
+#define TAMANHO_NOME 50    // Mesmo tamanho de Sala.nome e SuspeitoMansao.nome
+#define TAMANHO_PISTA 100  // Mesmo tamanho de PistaMansao.texto
+#define SEM_INDICE -1
+
+// Sala lida da descrição, antes de resolver os nomes dos filhos
+typedef struct SalaLida {
+    char nome[TAMANHO_NOME];
+    char esquerda[TAMANHO_NOME];
+    char direita[TAMANHO_NOME];
+    char pista[TAMANHO_PISTA];
+    char suspeito[TAMANHO_NOME];
+    int linha;
+    int indiceEsquerda;
+    int indiceDireita;
+    int indicePista;
+} SalaLida;
+
+// Pista distinta encontrada na descrição
+typedef struct PistaLida {
+    char texto[TAMANHO_PISTA];
+    int suspeito;
+} PistaLida;
+
+SalaLida salas[MAXIMO_SALAS];
+int totalSalas = 0;
+
+PistaLida pistas[MAXIMO_SALAS];
+int totalPistas = 0;
+
+char suspeitos[MAXIMO_SALAS][TAMANHO_NOME];
+int totalSuspeitos = 0;
+
+const char* arquivoMapa = NULL;
+
+// ============================================================================
+// LEITURA DA DESCRIÇÃO
+// ============================================================================
+
+// Função para abortar a geração com uma mensagem de erro
+void erro(int linha, const char* mensagem, const char* detalhe) {
+    if (linha > 0) {
+        fprintf(stderr, "%s:%d: %s", arquivoMapa, linha, mensagem);
+    } else {
+        fprintf(stderr, "%s: %s", arquivoMapa, mensagem);
+    }
+    if (detalhe != NULL) {
+        fprintf(stderr, " \"%s\"", detalhe);
+    }
+    fprintf(stderr, "\n");
+    exit(1);
+}
+
+// Função para remover espaços no início e no fim de um texto
+char* aparar(char* texto) {
+    while (*texto == ' ' || *texto == '\t') {
+        texto++;
+    }
+    size_t tamanho = strlen(texto);
+    while (tamanho > 0 && (texto[tamanho - 1] == ' ' || texto[tamanho - 1] == '\t' ||
+                           texto[tamanho - 1] == '\n' || texto[tamanho - 1] == '\r')) {
+        texto[--tamanho] = '\0';
+    }
+    return texto;
+}
+
+// Função para copiar um campo, tratando "-" como vazio. Caracteres de
+// controle são recusados: o jogo exibe os nomes no terminal e os grava no
+// diário de investigação.
+void copiarCampo(char* destino, const char* campo, size_t tamanho, int linha) {
+    if (strcmp(campo, "-") == 0) {
+        campo = "";
+    }
+    if (strlen(campo) >= tamanho) {
+        erro(linha, "campo longo demais:", campo);
+    }
+    for (const char* c = campo; *c != '\0'; c++) {
+        if ((unsigned char)*c < 0x20 || *c == 0x7f) {
+            erro(linha, "caractere de controle no campo:", campo);
+        }
+    }
+    strcpy(destino, campo);
+}
+
+// Função para ler as salas do arquivo de descrição
+void lerDescricao(FILE* arquivo) {
+    char linha[TAMANHO_LINHA];
+    int numeroLinha = 0;
+
+    while (fgets(linha, sizeof(linha), arquivo) != NULL) {
+        numeroLinha++;
+        if (strchr(linha, '\n') == NULL && !feof(arquivo)) {
+            erro(numeroLinha, "linha longa demais", NULL);
+        }
+        char* conteudo = aparar(linha);
+        if (conteudo[0] == '\0' || conteudo[0] == '#') {
+            continue;
+        }
+        if (totalSalas == MAXIMO_SALAS) {
+            erro(numeroLinha, "salas demais na mansão", NULL);
+        }
+
+        int separadores = 0;
+        for (const char* c = conteudo; *c != '\0'; c++) {
+            if (*c == '|') {
+                separadores++;
+            }
+        }
+        if (separadores != 4) {
+            erro(numeroLinha, "esperados 5 campos: sala | esquerda | direita | pista | suspeito", NULL);
+        }
+
+        char* campos[5];
+        char* inicio = conteudo;
+        for (int i = 0; i < 5; i++) {
+            char* separador = strchr(inicio, '|');
+            if (separador != NULL) {
+                *separador = '\0';
+            }
+            campos[i] = aparar(inicio);
+            if (separador != NULL) {
+                inicio = separador + 1;
+            }
+        }
+
+        SalaLida* sala = &salas[totalSalas++];
+        copiarCampo(sala->nome, campos[0], TAMANHO_NOME, numeroLinha);
+        copiarCampo(sala->esquerda, campos[1], TAMANHO_NOME, numeroLinha);
+        copiarCampo(sala->direita, campos[2], TAMANHO_NOME, numeroLinha);
+        copiarCampo(sala->pista, campos[3], TAMANHO_PISTA, numeroLinha);
+        copiarCampo(sala->suspeito, campos[4], TAMANHO_NOME, numeroLinha);
+        sala->linha = numeroLinha;
+
+        if (sala->nome[0] == '\0') {
+            erro(numeroLinha, "sala sem nome", NULL);
+        }
+        if (sala->pista[0] == '\0' && sala->suspeito[0] != '\0') {
+            erro(numeroLinha, "suspeito sem pista na sala", sala->nome);
+        }
+    }
+
+    if (totalSalas == 0) {
+        erro(0, "nenhuma sala descrita", NULL);
+    }
+}
+
+// ============================================================================
+// RESOLUÇÃO E VALIDAÇÃO
+// ============================================================================
+
+// Função para buscar o índice de uma sala pelo nome
+int buscarSala(const char* nome) {
+    for (int i = 0; i < totalSalas; i++) {
+        if (strcmp(salas[i].nome, nome) == 0) {
+            return i;
+        }
+    }
+    return SEM_INDICE;
+}
+
+// Função para resolver o nome de um filho em índice
+int resolverFilho(const SalaLida* sala, const char* nomeFilho) {
+    if (nomeFilho[0] == '\0') {
+        return SEM_INDICE;
+    }
+    int indice = buscarSala(nomeFilho);
+    if (indice == SEM_INDICE) {
+        erro(sala->linha, "sala inexistente:", nomeFilho);
+    }
+    return indice;
+}
+
+// Função para buscar ou cadastrar um suspeito
+int buscarOuCriarSuspeito(const char* nome) {
+    for (int i = 0; i < totalSuspeitos; i++) {
+        if (strcmp(suspeitos[i], nome) == 0) {
+            return i;
+        }
+    }
+    strcpy(suspeitos[totalSuspeitos], nome);
+    return totalSuspeitos++;
+}
+
+// Função para buscar ou cadastrar uma pista (a mesma pista deve sempre
+// apontar para o mesmo suspeito)
+int buscarOuCriarPista(const SalaLida* sala) {
+    int suspeito = SEM_INDICE;
+    if (sala->suspeito[0] != '\0') {
+        suspeito = buscarOuCriarSuspeito(sala->suspeito);
+    }
+
+    for (int i = 0; i < totalPistas; i++) {
+        if (strcmp(pistas[i].texto, sala->pista) == 0) {
+            if (pistas[i].suspeito != suspeito) {
+                erro(sala->linha, "pista associada a suspeitos diferentes:", sala->pista);
+            }
+            return i;
+        }
+    }
+    strcpy(pistas[totalPistas].texto, sala->pista);
+    pistas[totalPistas].suspeito = suspeito;
+    return totalPistas++;
+}
+
+// Função para resolver nomes em índices e garantir que as salas formam uma
+// árvore binária com raiz na primeira sala
+void resolverMansao() {
+    int pais[MAXIMO_SALAS];
+
+    for (int i = 0; i < totalSalas; i++) {
+        if (buscarSala(salas[i].nome) != i) {
+            erro(salas[i].linha, "sala repetida:", salas[i].nome);
+        }
+        pais[i] = 0;
+    }
+
+    for (int i = 0; i < totalSalas; i++) {
+        SalaLida* sala = &salas[i];
+        sala->indiceEsquerda = resolverFilho(sala, sala->esquerda);
+        sala->indiceDireita = resolverFilho(sala, sala->direita);
+        sala->indicePista = SEM_INDICE;
+        if (sala->pista[0] != '\0') {
+            sala->indicePista = buscarOuCriarPista(sala);
+        }
+
+        int filhos[2] = {sala->indiceEsquerda, sala->indiceDireita};
+        for (int f = 0; f < 2; f++) {
+            if (filhos[f] == SEM_INDICE) {
+                continue;
+            }
+            if (filhos[f] == 0) {
+                erro(sala->linha, "a sala raiz não pode ser filha de outra:", salas[0].nome);
+            }
+            if (++pais[filhos[f]] > 1) {
+                erro(sala->linha, "sala alcançada por mais de um caminho:", salas[filhos[f]].nome);
+            }
+        }
+    }
+
+    // Percorrer a mansão a partir da raiz: como cada sala tem no máximo um
+    // pai e a raiz não tem nenhum, o percurso termina, e as salas que ele não
+    // visita estão soltas ou presas em um ciclo
+    int alcancada[MAXIMO_SALAS] = {0};
+    int pilha[MAXIMO_SALAS];
+    int topo = 0;
+    pilha[topo++] = 0;
+    while (topo > 0) {
+        int atual = pilha[--topo];
+        alcancada[atual] = 1;
+        if (salas[atual].indiceEsquerda != SEM_INDICE) {
+            pilha[topo++] = salas[atual].indiceEsquerda;
+        }
+        if (salas[atual].indiceDireita != SEM_INDICE) {
+            pilha[topo++] = salas[atual].indiceDireita;
+        }
+    }
+    for (int i = 1; i < totalSalas; i++) {
+        if (!alcancada[i]) {
+            erro(salas[i].linha, "sala inalcançável a partir da raiz:", salas[i].nome);
+        }
+    }
+}
+
+// ============================================================================
+// GERAÇÃO DO CÓDIGO C
+// ============================================================================
+
+// Função para escrever um texto como literal de string C
+void escreverString(FILE* saida, const char* texto) {
+    fputc('"', saida);
+    for (const char* c = texto; *c != '\0'; c++) {
+        // '?' também é escapado para não formar trígrafos (como "??/")
+        if (*c == '"' || *c == '\\' || *c == '?') {
+            fputc('\\', saida);
+        }
+        fputc(*c, saida);
+    }
+    fputc('"', saida);
+}
+
+// Função para acumular bytes na impressão digital da mansão (FNV-1a, 32 bits)
+unsigned long misturarImpressao(unsigned long impressao, const void* dados, size_t tamanho) {
+    const unsigned char* bytes = (const unsigned char*)dados;
+    for (size_t i = 0; i < tamanho; i++) {
+        impressao ^= bytes[i];
+        impressao = (impressao * 16777619UL) & 0xFFFFFFFFUL;
+    }
+    return impressao;
+}
+
+// Função para acumular um índice na impressão digital, sempre em 4 bytes
+// little-endian para não depender da plataforma
+unsigned long misturarIndice(unsigned long impressao, int indice) {
+    unsigned long valor = (unsigned long)indice & 0xFFFFFFFFUL;
+    unsigned char bytes[4];
+    for (int i = 0; i < 4; i++) {
+        bytes[i] = (unsigned char)(valor >> (8 * i));
+    }
+    return misturarImpressao(impressao, bytes, sizeof(bytes));
+}
+
+// Função para calcular a impressão digital de todas as tabelas geradas. O
+// jogo a grava no diário para não reproduzir uma partida em outro mapa.
+unsigned long calcularImpressao() {
+    unsigned long impressao = 2166136261UL;
+    for (int i = 0; i < totalSalas; i++) {
+        impressao = misturarImpressao(impressao, salas[i].nome, strlen(salas[i].nome) + 1);
+        impressao = misturarIndice(impressao, salas[i].indiceEsquerda);
+        impressao = misturarIndice(impressao, salas[i].indiceDireita);
+        impressao = misturarIndice(impressao, salas[i].indicePista);
+    }
+    for (int i = 0; i < totalPistas; i++) {
+        impressao = misturarImpressao(impressao, pistas[i].texto, strlen(pistas[i].texto) + 1);
+        impressao = misturarIndice(impressao, pistas[i].suspeito);
+    }
+    for (int i = 0; i < totalSuspeitos; i++) {
+        impressao = misturarImpressao(impressao, suspeitos[i], strlen(suspeitos[i]) + 1);
+    }
+    return impressao;
+}
+
+// Função para escrever o índice de uma tabela (ou SEM_INDICE)
+void escreverIndice(FILE* saida, int indice) {
+    if (indice == SEM_INDICE) {
+        fprintf(saida, "SEM_INDICE");
+    } else {
+        fprintf(saida, "%d", indice);
+    }
+}
+
+// Função para gerar o cabeçalho com as tabelas da mansão
+void gerarTabelas(FILE* saida) {
+    fprintf(saida, "// Arquivo gerado por gerar_mansao a partir de %s. Não edite à mão:\n", arquivoMapa);
+    fprintf(saida, "// altere a descrição da mansão e rode \"make mansao\".\n\n");
+
+    fprintf(saida, "#define TOTAL_SALAS %d\n", totalSalas);
+    fprintf(saida, "#define TOTAL_PISTAS %d\n", totalPistas);
+    fprintf(saida, "#define TOTAL_SUSPEITOS %d\n\n", totalSuspeitos);
+
+    // Impressão digital das tabelas, gravada no cabeçalho do diário
+    fprintf(saida, "#define IMPRESSAO_MANSAO 0x%08lXUL\n\n", calcularImpressao());
+
+    // Salas: nome, esquerda, direita, pista (a sala 0 é a raiz)
+    fprintf(saida, "static const Sala salasMansao[] = {\n");
+    for (int i = 0; i < totalSalas; i++) {
+        fprintf(saida, "    {");
+        escreverString(saida, salas[i].nome);
+        fprintf(saida, ", ");
+        escreverIndice(saida, salas[i].indiceEsquerda);
+        fprintf(saida, ", ");
+        escreverIndice(saida, salas[i].indiceDireita);
+        fprintf(saida, ", ");
+        escreverIndice(saida, salas[i].indicePista);
+        fprintf(saida, "},  // %d\n", i);
+    }
+    fprintf(saida, "};\n\n");
+
+    // Pistas: texto, suspeito associado. Um array C não pode ser vazio,
+    // então mansões sem pistas ou suspeitos recebem uma entrada nunca usada.
+    fprintf(saida, "static const PistaMansao pistasMansao[] = {\n");
+    for (int i = 0; i < totalPistas; i++) {
+        fprintf(saida, "    {");
+        escreverString(saida, pistas[i].texto);
+        fprintf(saida, ", ");
+        escreverIndice(saida, pistas[i].suspeito);
+        fprintf(saida, "},  // %d\n", i);
+    }
+    if (totalPistas == 0) {
+        fprintf(saida, "    {\"\", SEM_INDICE},  // não usada\n");
+    }
+    fprintf(saida, "};\n\n");
+
+    fprintf(saida, "static const SuspeitoMansao suspeitosMansao[] = {\n");
+    for (int i = 0; i < totalSuspeitos; i++) {
+        fprintf(saida, "    {");
+        escreverString(saida, suspeitos[i]);
+        fprintf(saida, "},  // %d\n", i);
+    }
+    if (totalSuspeitos == 0) {
+        fprintf(saida, "    {\"\"},  // não usada\n");
+    }
+    fprintf(saida, "};\n");
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        fprintf(stderr, "Uso: %s <descricao_mansao.txt> <saida.h>\n", argv[0]);
+        return 1;
+    }
+    arquivoMapa = argv[1];
+
+    FILE* entrada = fopen(arquivoMapa, "r");
+    if (entrada == NULL) {
+        erro(0, "não foi possível abrir a descrição da mansão", NULL);
+    }
+    lerDescricao(entrada);
+    fclose(entrada);
+
+    resolverMansao();
+
+    FILE* saida = fopen(argv[2], "w");
+    if (saida == NULL) {
+        fprintf(stderr, "%s: não foi possível criar o arquivo\n", argv[2]);
+        return 1;
+    }
+    gerarTabelas(saida);
+    if (fclose(saida) != 0) {
+        fprintf(stderr, "%s: erro ao gravar o arquivo\n", argv[2]);
+        remove(argv[2]);
+        return 1;
+    }
+
+    printf("Mansão gerada: %d sala(s), %d pista(s), %d suspeito(s) -> %s\n",
+           totalSalas, totalPistas, totalSuspeitos, argv[2]);
+    return 0;
+}